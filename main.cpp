@@ -3,6 +3,32 @@
 #include <iostream>
 #include <vector>
 #include <cctype>
+#include <map>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <random>
+#include <string_view>
+#include <charconv>
+#include <algorithm>
+#include <queue>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -22,25 +48,53 @@ public:
     int inStock;
     string category;
     int totalSold;
+    int onHold;
+    int serial; // identifies this item across delete and re-add of the same foodNo
     FoodNode* left;
     FoodNode* right;
 
     FoodNode(int number, string foodName, double foodPrice, int stock, string cat)
         : foodNo(number), name(foodName), price(foodPrice), inStock(stock),
-        category(cat), totalSold(0), left(nullptr), right(nullptr) {
+        category(cat), totalSold(0), onHold(0), serial(0), left(nullptr), right(nullptr) {
     }
 };
 
+// One menu item as read from an import file; the views point into the file
+struct MenuRow {
+    int foodNo;
+    string_view name;
+    double price;
+    int stock;
+    string_view category;
+};
+
+// Luhn checksum over a string of digits
+bool luhnValid(const string& cardNumber) {
+    static const int doubled[10] = { 0, 2, 4, 6, 8, 1, 3, 5, 7, 9 };
+    int sum = 0;
+    bool doubleDigit = false;
+    for (size_t i = cardNumber.size(); i-- > 0;) {
+        int digit = cardNumber[i] - '0';
+        if (digit < 0 || digit > 9) return false;
+        sum += doubleDigit ? doubled[digit] : digit;
+        doubleDigit = !doubleDigit;
+    }
+    return sum % 10 == 0;
+}
+
 class FoodManagementSystem {
 private:
     FoodNode* root;
     ListNode* orderHistory;
     ListNode* adminLogs;
     double totalRevenue;
+    int nextSerial;
 
     FoodNode* insert(FoodNode* node, int number, string name, double price, int stock, string category) {
         if (node == nullptr) {
-            return new FoodNode(number, name, price, stock, category);
+            FoodNode* food = new FoodNode(number, name, price, stock, category);
+            food->serial = nextSerial++;
+            return food;
         }
         if (number < node->foodNo) {
             node->left = insert(node->left, number, name, price, stock, category);
@@ -57,8 +111,18 @@ private:
         return findFood(node->right, number);
     }
 
+    // Links nodes[lo, hi), sorted by foodNo, into a balanced subtree
+    FoodNode* buildBalanced(vector<FoodNode*>& nodes, size_t lo, size_t hi) {
+        if (lo >= hi) return nullptr;
+        size_t mid = lo + (hi - lo) / 2;
+        FoodNode* node = nodes[mid];
+        node->left = buildBalanced(nodes, lo, mid);
+        node->right = buildBalanced(nodes, mid + 1, hi);
+        return node;
+    }
+
 public:
-    FoodManagementSystem() : root(nullptr), orderHistory(nullptr), adminLogs(nullptr), totalRevenue(0) {}
+    FoodManagementSystem() : root(nullptr), orderHistory(nullptr), adminLogs(nullptr), totalRevenue(0), nextSerial(1) {}
 
     void insertFood(int number, string name, double price, int stock, string category) {
         root = insert(root, number, name, price, stock, category);
@@ -93,30 +157,102 @@ public:
         return foods;
     }
 
+    // Immediate sale with no payment step
     void processOrder(int orderNo, int quantity) {
+        int holdSerial;
+        if (holdStock(orderNo, quantity, holdSerial)) commitHold(orderNo, holdSerial, quantity);
+    }
+
+    // Reserves stock for an order whose payment is still pending. holdSerial
+    // names the exact item held, so a later commit or release can tell if it
+    // was deleted and re-added under the same foodNo in the meantime.
+    bool holdStock(int orderNo, int quantity, int& holdSerial) {
         FoodNode* food = findFood(orderNo);
-        if (food && food->inStock >= quantity) {
-            double totalPrice = food->price * quantity;
-            food->inStock -= quantity;
-            food->totalSold += quantity;
-            totalRevenue += totalPrice;
+        if (!food || quantity <= 0 || food->inStock < quantity) return false;
+        food->inStock -= quantity;
+        food->onHold += quantity;
+        holdSerial = food->serial;
+        return true;
+    }
+
+    // The held item if it still exists and still carries the hold
+    FoodNode* findHold(int orderNo, int holdSerial, int quantity) {
+        FoodNode* food = findFood(orderNo);
+        if (!food || food->serial != holdSerial || food->onHold < quantity) return nullptr;
+        return food;
+    }
+
+    // Payment approved: the held stock becomes a sale. Fails if the item was
+    // deleted (or replaced) while the payment was pending.
+    bool commitHold(int orderNo, int holdSerial, int quantity) {
+        FoodNode* food = findHold(orderNo, holdSerial, quantity);
+        if (!food) {
+            addAdminLog("Sale Lost: " + to_string(quantity) + " x item " + to_string(orderNo) +
+                " was deleted during payment, authorization voided");
+            return false;
         }
+        food->onHold -= quantity;
+        food->totalSold += quantity;
+        totalRevenue += food->price * quantity;
+        return true;
+    }
+
+    // Payment declined or timed out: put the held stock back. Nothing to do if
+    // the held item is gone, since its stock went with it.
+    void releaseHold(int orderNo, int holdSerial, int quantity) {
+        FoodNode* food = findHold(orderNo, holdSerial, quantity);
+        if (!food) return;
+        food->onHold -= quantity;
+        food->inStock += quantity;
+    }
+
+    // Local card checks, run by the payment stage before anything reaches the processor
+    static bool validateCard(const string& cardNumber, const string& cardPassword) {
+        return cardNumber.size() == 16 && !cardPassword.empty() && luhnValid(cardNumber);
     }
 
-    bool validateCard(const string& cardNumber, const string& cardPassword) {
-        // Very basic validation
-        if (cardNumber.size() == 16 && !cardPassword.empty()) {
-            return true;
+    // Adds or updates many items in one pass and rebuilds the tree balanced.
+    // rows must be sorted by foodNo with no duplicates. As in updateFood, an
+    // imported stock is the total stock, including units held for payments.
+    void applyMenuBatch(const vector<MenuRow>& rows, const string& source) {
+        vector<FoodNode*> existing = getAllFoods();
+        vector<FoodNode*> merged;
+        merged.reserve(existing.size() + rows.size());
+        size_t added = 0, updated = 0, i = 0;
+
+        for (const MenuRow& row : rows) {
+            while (i < existing.size() && existing[i]->foodNo < row.foodNo) {
+                merged.push_back(existing[i++]);
+            }
+            if (i < existing.size() && existing[i]->foodNo == row.foodNo) {
+                FoodNode* food = existing[i++];
+                food->name.assign(row.name);
+                food->price = row.price;
+                food->inStock = max(0, row.stock - food->onHold);
+                food->category.assign(row.category);
+                merged.push_back(food);
+                updated++;
+            }
+            else {
+                FoodNode* food = new FoodNode(row.foodNo, string(row.name), row.price, row.stock, string(row.category));
+                food->serial = nextSerial++;
+                merged.push_back(food);
+                added++;
+            }
         }
-        return false;
+        while (i < existing.size()) merged.push_back(existing[i++]);
+
+        root = buildBalanced(merged, 0, merged.size());
+        addAdminLog("Imported Menu: " + source + " (" + to_string(added) + " added, " + to_string(updated) + " updated)");
     }
 
+    // newStock is the item's total stock, including any held for pending payments
     bool updateFood(int number, string newName, double newPrice, int newStock, string newCategory) {
         FoodNode* food = findFood(root, number);
         if (!food) return false;
         food->name = newName;
         food->price = newPrice;
-        food->inStock = newStock;
+        food->inStock = max(0, newStock - food->onHold);
         food->category = newCategory;
         addAdminLog("Updated Food Item: " + newName + " (" + newCategory + ")");
         return true;
@@ -156,6 +292,8 @@ public:
                 node->price = temp->price;
                 node->inStock = temp->inStock;
                 node->category = temp->category;
+                node->onHold = temp->onHold;
+                node->serial = temp->serial;
                 node->right = deleteFood(node->right, temp->foodNo);
             }
         }
@@ -171,6 +309,853 @@ public:
 
 };
 
+// -------------------- Payment Authorization --------------------
+struct PaymentRequest {
+    int orderId;
+    int foodNo;
+    int quantity;
+    double amount;
+    string cardNumber;
+    string cardPassword;
+    int holdSerial;
+    chrono::steady_clock::time_point deadline; // stock hold expires here
+};
+
+enum class PaymentStatus {
+    Approved,
+    Declined,
+    TimedOut,
+    Voided // approved, but the item was gone by the time it settled
+};
+
+struct PaymentResult {
+    PaymentRequest request;
+    PaymentStatus status;
+};
+
+// The only card check an order goes through: validateCard on each request a
+// worker took off the queue. The PIN is not needed past this point, so it is
+// wiped here.
+void validateCardBatch(vector<PaymentRequest>& batch, vector<char>& valid) {
+    valid.resize(batch.size());
+    for (size_t i = 0; i < batch.size(); i++) {
+        valid[i] = FoodManagementSystem::validateCard(batch[i].cardNumber, batch[i].cardPassword);
+        batch[i].cardPassword.clear();
+    }
+}
+
+// Interface for whatever sits behind the card reader
+class PaymentProcessor {
+public:
+    virtual ~PaymentProcessor() {}
+    // approved[i] is filled in for batch[i]
+    virtual void authorizeBatch(const vector<PaymentRequest>& batch, vector<char>& approved) = 0;
+    // Reverses an approval whose order could not be completed
+    virtual void voidAuthorization(const PaymentRequest& request) = 0;
+    // Processors with a bulk reversal call should override this
+    virtual void voidBatch(const vector<PaymentRequest>& batch) {
+        for (auto& request : batch) voidAuthorization(request);
+    }
+};
+
+// Local stand-in for a real processor: fixed round-trip time, random declines
+class MockPaymentProcessor : public PaymentProcessor {
+private:
+    chrono::milliseconds latency;
+    double failureRate;
+    mt19937 rng;
+    mutex rngMutex;
+    size_t charged;
+    size_t voided;
+
+public:
+    MockPaymentProcessor(int latencyMs, double failRate, unsigned seed = 42)
+        : latency(latencyMs), failureRate(failRate), rng(seed), charged(0), voided(0) {
+    }
+
+    void authorizeBatch(const vector<PaymentRequest>& batch, vector<char>& approved) override {
+        this_thread::sleep_for(latency);
+        uniform_real_distribution<double> roll(0.0, 1.0);
+        lock_guard<mutex> lock(rngMutex);
+        approved.resize(batch.size());
+        for (size_t i = 0; i < batch.size(); i++) {
+            approved[i] = roll(rng) >= failureRate;
+            if (approved[i]) charged++;
+        }
+    }
+
+    void voidAuthorization(const PaymentRequest& request) override {
+        voidBatch({ request });
+    }
+
+    void voidBatch(const vector<PaymentRequest>& batch) override {
+        this_thread::sleep_for(latency);
+        lock_guard<mutex> lock(rngMutex);
+        voided += batch.size();
+    }
+
+    // Approvals that were not voided, i.e. money actually taken
+    size_t netCharges() {
+        lock_guard<mutex> lock(rngMutex);
+        return charged - voided;
+    }
+};
+
+// Sits between the cart and the sale. submit() holds the stock and queues the
+// request; worker threads batch queued requests and keep several batches in
+// flight at the processor. A worker is added whenever a full batch is waiting
+// and none is idle, so the batches in flight grow with processor latency (up
+// to maxInFlight) and throughput follows demand instead of 1 / latency.
+// poll() runs on the UI thread every frame and settles finished or expired
+// orders, so FoodManagementSystem is only ever touched from there. An
+// approval for an order whose hold has already expired is voided, never
+// committed.
+class PaymentStage {
+private:
+    struct PendingOrder {
+        PaymentRequest request;
+        chrono::steady_clock::time_point deadline;
+    };
+
+    PaymentProcessor& processor;
+    size_t batchSize;
+    size_t maxInFlight;
+    chrono::milliseconds holdTimeout;
+    int nextOrderId;
+    map<int, PendingOrder> pending; // UI thread only, ordered by id and so by deadline
+
+    mutex queueMutex;
+    condition_variable queueReady;
+    deque<PaymentRequest> requestQueue;
+    deque<PaymentRequest> voidQueue;
+    vector<PaymentResult> resultQueue;
+    bool stopping;
+    size_t idleWorkers;
+    size_t outstanding; // submitted but not yet handed back through poll()
+    vector<thread> workers;
+
+    // Caller holds queueMutex
+    void addWorkerIfBusy() {
+        bool fullBatchWaiting = requestQueue.size() >= batchSize || voidQueue.size() >= batchSize;
+        if (idleWorkers == 0 && fullBatchWaiting && workers.size() < maxInFlight) {
+            idleWorkers++; // counted from now, not from when the thread first waits
+            workers.emplace_back(&PaymentStage::workerLoop, this);
+        }
+    }
+
+    void workerLoop() {
+        vector<PaymentRequest> batch;
+        vector<PaymentRequest> authorizeList;
+        vector<char> valid;
+        vector<char> approved;
+        vector<PaymentResult> results;
+        vector<PaymentRequest> voids;
+        bool firstWait = true;
+
+        while (true) {
+            {
+                unique_lock<mutex> lock(queueMutex);
+                if (!firstWait) idleWorkers++;
+                firstWait = false;
+                queueReady.wait(lock, [this] { return stopping || !requestQueue.empty() || !voidQueue.empty(); });
+                idleWorkers--;
+                voids.clear();
+                while (!voidQueue.empty() && voids.size() < batchSize) {
+                    voids.push_back(move(voidQueue.front()));
+                    voidQueue.pop_front();
+                }
+                batch.clear();
+                if (voids.empty() && stopping) return;
+                while (!stopping && !requestQueue.empty() && batch.size() < batchSize) {
+                    batch.push_back(move(requestQueue.front()));
+                    requestQueue.pop_front();
+                }
+            }
+
+            // Reversals go first so a charge never outlives its order for long
+            if (!voids.empty()) processor.voidBatch(voids);
+            if (batch.empty()) continue;
+
+            // Cards that fail the local checks, or whose hold has already
+            // expired, never reach the processor
+            validateCardBatch(batch, valid);
+            auto now = chrono::steady_clock::now();
+            authorizeList.clear();
+            for (size_t i = 0; i < batch.size(); i++) {
+                if (valid[i] && batch[i].deadline > now) authorizeList.push_back(batch[i]);
+            }
+            approved.clear();
+            if (!authorizeList.empty()) {
+                processor.authorizeBatch(authorizeList, approved);
+            }
+
+            results.clear();
+            size_t next = 0;
+            for (size_t i = 0; i < batch.size(); i++) {
+                PaymentStatus status = PaymentStatus::Declined;
+                if (valid[i] && batch[i].deadline > now)
+                    status = approved[next++] ? PaymentStatus::Approved : PaymentStatus::Declined;
+                else if (valid[i])
+                    status = PaymentStatus::TimedOut;
+                results.push_back({ move(batch[i]), status });
+            }
+
+            lock_guard<mutex> lock(queueMutex);
+            resultQueue.insert(resultQueue.end(), results.begin(), results.end());
+        }
+    }
+
+public:
+    PaymentStage(PaymentProcessor& proc, size_t maxBatch = 32, size_t inFlightLimit = 64, int holdTimeoutMs = 5000)
+        : processor(proc), batchSize(maxBatch), maxInFlight(inFlightLimit), holdTimeout(holdTimeoutMs),
+        nextOrderId(1), stopping(false), idleWorkers(0), outstanding(0) {
+        lock_guard<mutex> lock(queueMutex);
+        idleWorkers++;
+        workers.emplace_back(&PaymentStage::workerLoop, this);
+    }
+
+    ~PaymentStage() {
+        {
+            lock_guard<mutex> lock(queueMutex);
+            stopping = true;
+        }
+        queueReady.notify_all();
+        for (auto& worker : workers) worker.join();
+
+        // Nobody will commit these orders any more, so their charges must go
+        vector<PaymentRequest> reversals;
+        for (auto& result : resultQueue) {
+            if (result.status == PaymentStatus::Approved) reversals.push_back(result.request);
+        }
+        if (!reversals.empty()) processor.voidBatch(reversals);
+    }
+
+    // Returns the order id, or -1 if the stock could not be held
+    int submit(FoodManagementSystem& fms, int foodNo, int quantity, const string& cardNumber, const string& cardPassword) {
+        int holdSerial;
+        if (!fms.holdStock(foodNo, quantity, holdSerial)) return -1;
+        FoodNode* food = fms.findFood(foodNo);
+
+        int orderId = nextOrderId++;
+        auto deadline = chrono::steady_clock::now() + holdTimeout;
+        PaymentRequest request{ orderId, foodNo, quantity, food->price * quantity, cardNumber, "", holdSerial, deadline };
+        pending[orderId] = { request, deadline }; // kept without the PIN
+        request.cardPassword = cardPassword;
+        {
+            lock_guard<mutex> lock(queueMutex);
+            requestQueue.push_back(move(request));
+            outstanding++;
+            addWorkerIfBusy();
+        }
+        queueReady.notify_one();
+        return orderId;
+    }
+
+    // Settles answered and expired orders; never blocks on the processor
+    void poll(FoodManagementSystem& fms, vector<PaymentResult>& settled) {
+        vector<PaymentResult> answered;
+        {
+            lock_guard<mutex> lock(queueMutex);
+            answered.swap(resultQueue);
+            outstanding -= answered.size();
+        }
+
+        auto now = chrono::steady_clock::now();
+        vector<PaymentRequest> reversals;
+        for (auto& result : answered) {
+            auto it = pending.find(result.request.orderId);
+            bool expired = it == pending.end() || it->second.deadline <= now;
+            if (result.status == PaymentStatus::Approved && expired) {
+                // The hold is gone (or going), so the customer must not stay charged
+                reversals.push_back(result.request);
+                result.status = PaymentStatus::TimedOut;
+            }
+            if (it == pending.end()) continue; // already released on timeout
+
+            if (result.status == PaymentStatus::Approved) {
+                if (!fms.commitHold(result.request.foodNo, result.request.holdSerial, result.request.quantity)) {
+                    reversals.push_back(result.request);
+                    result.status = PaymentStatus::Voided;
+                }
+            }
+            else
+                fms.releaseHold(result.request.foodNo, result.request.holdSerial, result.request.quantity);
+            pending.erase(it);
+            settled.push_back(result);
+        }
+
+        while (!pending.empty() && pending.begin()->second.deadline <= now) {
+            const PaymentRequest& request = pending.begin()->second.request;
+            fms.releaseHold(request.foodNo, request.holdSerial, request.quantity);
+            settled.push_back({ request, PaymentStatus::TimedOut });
+            pending.erase(pending.begin());
+        }
+
+        if (!reversals.empty()) {
+            {
+                lock_guard<mutex> lock(queueMutex);
+                voidQueue.insert(voidQueue.end(), reversals.begin(), reversals.end());
+                addWorkerIfBusy();
+            }
+            queueReady.notify_one();
+        }
+    }
+
+    // For screens that don't report payment outcomes but must keep holds moving
+    void poll(FoodManagementSystem& fms) {
+        vector<PaymentResult> settled;
+        poll(fms, settled);
+    }
+
+    size_t pendingCount() const { return pending.size(); }
+
+    // True while any order is held or any request or reversal is still at the processor
+    bool busy() {
+        lock_guard<mutex> lock(queueMutex);
+        return !pending.empty() || outstanding > 0 || !voidQueue.empty();
+    }
+
+    // Batches the stage can have at the processor at once right now
+    size_t pipelineDepth() {
+        lock_guard<mutex> lock(queueMutex);
+        return workers.size();
+    }
+};
+
+// -------------------- Menu Import --------------------
+// Read-only mapping of a whole file, so parsers can hand out string_views into it
+class MappedFile {
+private:
+    const char* bytes;
+    size_t length;
+    bool opened;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+
+public:
+    MappedFile(const string& path) : bytes(nullptr), length(0), opened(false) {
+#ifdef _WIN32
+        mapping = nullptr;
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize)) return;
+        length = static_cast<size_t>(fileSize.QuadPart);
+        opened = true;
+        if (length == 0) return;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) bytes = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!bytes) opened = false;
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat info;
+        if (fstat(fd, &info) == 0) {
+            length = static_cast<size_t>(info.st_size);
+            opened = true;
+            if (length > 0) {
+                void* view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (view == MAP_FAILED) opened = false;
+                else bytes = static_cast<const char*>(view);
+            }
+        }
+        close(fd); // the mapping stays valid after the descriptor is closed
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (bytes) UnmapViewOfFile(bytes);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (bytes) munmap(const_cast<char*>(bytes), length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return opened; }
+    const char* data() const { return bytes; }
+    size_t size() const { return bytes ? length : 0; }
+};
+
+struct ImportError {
+    size_t line;
+    string message;
+};
+
+struct ImportReport {
+    bool opened;
+    size_t rowsRead;
+    size_t rowsApplied;
+    vector<ImportError> errors;
+    double seconds;
+
+    double rowsPerSecond() const { return seconds > 0 ? rowsRead / seconds : 0; }
+};
+
+// A slice of the file parsed by one thread. Lines are counted from the start
+// of the slice and shifted to file lines once all slices are done.
+struct ImportChunk {
+    struct Row {
+        MenuRow row;
+        size_t line;
+    };
+
+    const char* begin;
+    const char* end;
+    bool skipHeader;
+    vector<Row> rows;
+    vector<ImportError> errors;
+    deque<string> unescaped; // backing storage for the rare fields that had escapes
+    size_t lines;
+};
+
+string_view trimField(string_view field) {
+    while (!field.empty() && (field.front() == ' ' || field.front() == '\t')) field.remove_prefix(1);
+    while (!field.empty() && (field.back() == ' ' || field.back() == '\t' || field.back() == '\r')) field.remove_suffix(1);
+    return field;
+}
+
+template <typename T>
+bool parseNumber(string_view field, T& value) {
+    if (!field.empty() && field.front() == '+') field.remove_prefix(1);
+    const char* last = field.data() + field.size();
+    auto result = from_chars(field.data(), last, value);
+    return !field.empty() && result.ec == errc() && result.ptr == last;
+}
+
+// Shared by the CSV and JSON parsers: converts and validates one record
+bool buildMenuRow(string_view foodNo, string_view name, string_view price, string_view stock,
+    string_view category, MenuRow& row, string& error) {
+    if (!parseNumber(foodNo, row.foodNo)) error = "Invalid foodNo '" + string(foodNo) + "'";
+    else if (!parseNumber(price, row.price)) error = "Invalid price '" + string(price) + "'";
+    else if (!parseNumber(stock, row.stock)) error = "Invalid stock '" + string(stock) + "'";
+    else if (!isfinite(row.price)) error = "Invalid price '" + string(price) + "'"; // from_chars accepts nan and inf
+    else if (row.price < 0) error = "Negative price";
+    else if (row.stock < 0) error = "Negative stock";
+    else if (name.empty() || category.empty()) error = "Name and Category cannot be empty";
+    else {
+        row.name = name;
+        row.category = category;
+        return true;
+    }
+    return false;
+}
+
+// Splits one CSV line into at most maxFields views and returns the real field
+// count. Quoted fields may contain commas; "" inside quotes becomes ".
+size_t splitCsvLine(string_view line, string_view* fields, size_t maxFields, deque<string>& unescaped) {
+    size_t count = 0;
+    size_t pos = 0;
+    while (true) {
+        while (pos < line.size() && line[pos] == ' ') pos++;
+        string_view field;
+        if (pos < line.size() && line[pos] == '"') {
+            size_t start = ++pos;
+            bool escaped = false;
+            while (pos < line.size()) {
+                if (line[pos] == '"') {
+                    if (pos + 1 < line.size() && line[pos + 1] == '"') {
+                        escaped = true;
+                        pos += 2;
+                        continue;
+                    }
+                    break;
+                }
+                pos++;
+            }
+            field = line.substr(start, pos - start);
+            if (escaped) {
+                string plain;
+                for (size_t i = 0; i < field.size(); i++) {
+                    plain += field[i];
+                    if (field[i] == '"') i++;
+                }
+                unescaped.push_back(move(plain));
+                field = unescaped.back();
+            }
+        }
+        size_t comma = line.find(',', pos);
+        if (field.data() == nullptr) field = trimField(line.substr(pos, comma == string_view::npos ? string_view::npos : comma - pos));
+        if (count < maxFields) fields[count] = field;
+        count++;
+        if (comma == string_view::npos) break;
+        pos = comma + 1;
+    }
+    return count;
+}
+
+// Expected columns: foodNo,name,price,stock,category. The first non-blank
+// line of the file is skipped only if it names exactly those columns.
+void parseCsvChunk(ImportChunk& chunk) {
+    static const string_view header[5] = { "foodNo", "name", "price", "stock", "category" };
+    string_view text(chunk.begin, chunk.end - chunk.begin);
+    string_view fields[5];
+    string error;
+    size_t pos = 0;
+    size_t lineNo = 0;
+    bool headerChecked = !chunk.skipHeader;
+
+    while (pos < text.size()) {
+        size_t newline = text.find('\n', pos);
+        size_t lineEnd = newline == string_view::npos ? text.size() : newline;
+        string_view line = text.substr(pos, lineEnd - pos);
+        lineNo++;
+        pos = lineEnd + 1;
+
+        if (trimField(line).empty()) continue;
+        size_t count = splitCsvLine(line, fields, 5, chunk.unescaped);
+        if (!headerChecked) {
+            headerChecked = true;
+            if (count == 5 && equal(fields, fields + 5, header)) continue;
+        }
+        if (count != 5) {
+            chunk.errors.push_back({ lineNo, "Expected 5 fields, found " + to_string(count) });
+            continue;
+        }
+
+        MenuRow row;
+        if (buildMenuRow(fields[0], fields[1], fields[2], fields[3], fields[4], row, error))
+            chunk.rows.push_back({ row, lineNo });
+        else
+            chunk.errors.push_back({ lineNo, error });
+    }
+    chunk.lines = count(chunk.begin, chunk.end, '\n');
+}
+
+// Appends code point cp to out as UTF-8
+void appendUtf8(string& out, unsigned cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    }
+    else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+// Decodes the body of a JSON string: the two-character escapes and \uXXXX,
+// including surrogate pairs, to UTF-8. Returns false on a malformed escape.
+bool unescapeJsonString(string_view raw, string& out) {
+    auto hex4 = [&](size_t at, unsigned& value) {
+        if (at + 4 > raw.size()) return false;
+        auto result = from_chars(raw.data() + at, raw.data() + at + 4, value, 16);
+        return result.ec == errc() && result.ptr == raw.data() + at + 4;
+    };
+
+    out.clear();
+    for (size_t i = 0; i < raw.size(); i++) {
+        if (raw[i] != '\\') {
+            out += raw[i];
+            continue;
+        }
+        if (++i >= raw.size()) return false;
+        switch (raw[i]) {
+        case '"': out += '"'; break;
+        case '\\': out += '\\'; break;
+        case '/': out += '/'; break;
+        case 'b': out += '\b'; break;
+        case 'f': out += '\f'; break;
+        case 'n': out += '\n'; break;
+        case 'r': out += '\r'; break;
+        case 't': out += '\t'; break;
+        case 'u': {
+            unsigned cp;
+            if (!hex4(i + 1, cp)) return false;
+            i += 4;
+            if (cp >= 0xD800 && cp <= 0xDBFF) {
+                // High surrogate: must be followed by \u and a low surrogate
+                unsigned low;
+                if (i + 2 >= raw.size() || raw[i + 1] != '\\' || raw[i + 2] != 'u' || !hex4(i + 3, low)) return false;
+                if (low < 0xDC00 || low > 0xDFFF) return false;
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                i += 6;
+            }
+            else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                return false;
+            }
+            appendUtf8(out, cp);
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+// Expected shape: [ {"foodNo": 1, "name": "Burger", "price": 5.99, "stock": 10, "category": "Fast Food"}, ... ]
+// Objects must be flat, which is what lets nextJsonCut split the file between them.
+void parseJsonChunk(ImportChunk& chunk) {
+    const char* p = chunk.begin;
+    const char* end = chunk.end;
+    size_t line = 1;
+    string error;
+
+    auto skipSpace = [&]() {
+        while (p < end && isspace(static_cast<unsigned char>(*p))) {
+            if (*p == '\n') line++;
+            p++;
+        }
+    };
+    // Reads a string body after the opening quote. Strings without escapes
+    // stay views into the file; the rest are decoded into chunk.unescaped.
+    bool badEscape = false;
+    auto readString = [&](string_view& out) {
+        const char* start = p;
+        bool escaped = false;
+        while (p < end && *p != '"') {
+            if (*p == '\\' && p + 1 < end) {
+                escaped = true;
+                p++;
+            }
+            p++;
+        }
+        out = string_view(start, p - start);
+        if (p < end) p++;
+        if (escaped) {
+            string plain;
+            if (!unescapeJsonString(out, plain)) badEscape = true;
+            chunk.unescaped.push_back(move(plain));
+            out = chunk.unescaped.back();
+        }
+    };
+
+    while (true) {
+        while (p < end && *p != '{') {
+            if (*p == '\n') line++;
+            p++;
+        }
+        if (p >= end) break;
+        size_t objectLine = line;
+        p++;
+
+        string_view foodNo, name, price, stock, category;
+        bool malformed = false;
+        badEscape = false;
+        while (true) {
+            skipSpace();
+            if (p < end && *p == '}') break;
+            string_view key, value;
+            if (p >= end || *p != '"') { malformed = true; break; }
+            p++;
+            readString(key);
+            skipSpace();
+            if (p >= end || *p != ':') { malformed = true; break; }
+            p++;
+            skipSpace();
+            if (p < end && *p == '"') {
+                p++;
+                readString(value);
+            }
+            else {
+                const char* start = p;
+                while (p < end && *p != ',' && *p != '}' && !isspace(static_cast<unsigned char>(*p))) p++;
+                value = string_view(start, p - start);
+            }
+
+            if (key == "foodNo") foodNo = value;
+            else if (key == "name") name = value;
+            else if (key == "price") price = value;
+            else if (key == "stock") stock = value;
+            else if (key == "category") category = value;
+
+            skipSpace();
+            if (p < end && *p == ',') { p++; continue; }
+            if (p < end && *p == '}') break;
+            malformed = true;
+            break;
+        }
+
+        if (malformed) {
+            chunk.errors.push_back({ objectLine, "Malformed JSON object" });
+            while (p < end && *p != '}') {
+                if (*p == '\n') line++;
+                p++;
+            }
+            continue;
+        }
+        p++;
+        if (badEscape) {
+            chunk.errors.push_back({ objectLine, "Invalid escape in JSON string" });
+            continue;
+        }
+
+        MenuRow row;
+        if (buildMenuRow(foodNo, name, price, stock, category, row, error))
+            chunk.rows.push_back({ row, objectLine });
+        else
+            chunk.errors.push_back({ objectLine, error });
+    }
+    chunk.lines = count(chunk.begin, chunk.end, '\n');
+}
+
+// Finds the end of a JSON slice at or after from. A raw newline can't occur
+// inside a JSON string, so scanning from the next newline starts outside any
+// string; for minified files with no newline left, scanning restarts at prev,
+// the previous cut, which is also outside a string. The slice ends after the
+// first '}' outside a string that is followed by ',' or ']'.
+const char* nextJsonCut(const char* prev, const char* from, const char* end) {
+    const char* p = static_cast<const char*>(memchr(from, '\n', end - from));
+    if (!p) p = prev;
+    bool inString = false;
+    for (; p < end; p++) {
+        if (inString) {
+            if (*p == '\\') p++;
+            else if (*p == '"') inString = false;
+        }
+        else if (*p == '"') {
+            inString = true;
+        }
+        else if (*p == '}' && p >= from) {
+            const char* next = p + 1;
+            while (next < end && isspace(static_cast<unsigned char>(*next))) next++;
+            if (next < end && (*next == ',' || *next == ']')) return p + 1;
+        }
+    }
+    return end;
+}
+
+// Maps the file, parses slices of it on every core, drops duplicate foodNo
+// rows (the first occurrence in the file wins), and applies the rest to fms
+// as one batch. Rows whose foodNo is already on the menu update that item.
+// chunkCount 0 means one slice per core (one slice for small files).
+ImportReport importMenuFile(FoodManagementSystem& fms, const string& path, size_t chunkCount = 0) {
+    ImportReport report{ false, 0, 0, {}, 0 };
+    auto start = chrono::steady_clock::now();
+
+    MappedFile file(path);
+    if (!file.isOpen()) return report;
+    report.opened = true;
+
+    const char* data = file.data();
+    size_t size = file.size();
+    // Excel and many Windows tools start UTF-8 files with a byte order mark
+    if (size >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0) {
+        data += 3;
+        size -= 3;
+    }
+    size_t first = 0;
+    while (first < size && isspace(static_cast<unsigned char>(data[first]))) first++;
+    bool json = first < size && (data[first] == '[' || data[first] == '{');
+
+    if (chunkCount == 0) {
+        chunkCount = max<size_t>(1, thread::hardware_concurrency());
+        // Small files are not worth the threads
+        if (size < 256 * 1024) chunkCount = 1;
+    }
+
+    vector<ImportChunk> chunks(chunkCount);
+    const char* cursor = data;
+    for (size_t i = 0; i < chunkCount; i++) {
+        const char* cut = data + size;
+        if (i + 1 < chunkCount) {
+            cut = max(cursor, data + size * (i + 1) / chunkCount);
+            if (json) {
+                cut = nextJsonCut(cursor, cut, data + size);
+            }
+            else {
+                // CSV fields may not contain newlines, so any newline ends a row
+                const char* found = static_cast<const char*>(memchr(cut, '\n', data + size - cut));
+                cut = found ? found + 1 : data + size;
+            }
+        }
+        chunks[i].begin = cursor;
+        chunks[i].end = cut;
+        chunks[i].skipHeader = i == 0;
+        cursor = cut;
+    }
+
+    auto parseChunk = [json](ImportChunk& chunk) {
+        if (json) parseJsonChunk(chunk);
+        else parseCsvChunk(chunk);
+        sort(chunk.rows.begin(), chunk.rows.end(), [](const ImportChunk::Row& a, const ImportChunk::Row& b) {
+            return a.row.foodNo != b.row.foodNo ? a.row.foodNo < b.row.foodNo : a.line < b.line;
+        });
+    };
+    vector<thread> workers;
+    for (size_t i = 1; i < chunkCount; i++) {
+        workers.emplace_back(parseChunk, ref(chunks[i]));
+    }
+    parseChunk(chunks[0]);
+    for (auto& worker : workers) worker.join();
+
+    // Shift chunk-local line numbers to file line numbers
+    vector<size_t> firstLine(chunkCount);
+    size_t nextLine = 1;
+    for (size_t i = 0; i < chunkCount; i++) {
+        firstLine[i] = nextLine;
+        nextLine += chunks[i].lines;
+        for (auto& error : chunks[i].errors) {
+            error.line += firstLine[i] - 1;
+            report.errors.push_back(move(error));
+        }
+        report.rowsRead += chunks[i].rows.size() + chunks[i].errors.size();
+    }
+
+    // k-way merge of the sorted chunks; ties come out in file order
+    typedef pair<int, pair<size_t, size_t>> HeapEntry; // foodNo, (chunk, index)
+    priority_queue<HeapEntry, vector<HeapEntry>, greater<HeapEntry>> heap;
+    for (size_t i = 0; i < chunkCount; i++) {
+        if (!chunks[i].rows.empty()) heap.push({ chunks[i].rows[0].row.foodNo, { i, 0 } });
+    }
+    vector<MenuRow> rows;
+    rows.reserve(report.rowsRead);
+    size_t lastLine = 0;
+    while (!heap.empty()) {
+        size_t c = heap.top().second.first;
+        size_t index = heap.top().second.second;
+        heap.pop();
+        const ImportChunk::Row& entry = chunks[c].rows[index];
+        size_t line = firstLine[c] + entry.line - 1;
+        if (!rows.empty() && rows.back().foodNo == entry.row.foodNo) {
+            report.errors.push_back({ line, "Duplicate foodNo " + to_string(entry.row.foodNo) +
+                " (first on line " + to_string(lastLine) + ")" });
+        }
+        else {
+            rows.push_back(entry.row);
+            lastLine = line;
+        }
+        if (++index < chunks[c].rows.size()) heap.push({ chunks[c].rows[index].row.foodNo, { c, index } });
+    }
+
+    if (!rows.empty()) fms.applyMenuBatch(rows, path);
+    report.rowsApplied = rows.size();
+    sort(report.errors.begin(), report.errors.end(), [](const ImportError& a, const ImportError& b) {
+        return a.line < b.line;
+    });
+    report.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+// Writes every per-row error to <path>.errors.log; returns the log path, or
+// an empty string if there was nothing to write or it could not be written
+string writeImportErrorLog(const ImportReport& report, const string& path) {
+    if (report.errors.empty()) return "";
+    string logPath = path + ".errors.log";
+    ofstream log(logPath);
+    for (auto& error : report.errors) {
+        log << "line " << error.line << ": " << error.message << "\n";
+    }
+    return log ? logPath : "";
+}
+
 // -------------------- Utility: Button Handling --------------------
 
 struct Button {
@@ -218,7 +1203,7 @@ enum class AppState {
 };
 
 // -------------------- MainMenu State Handling --------------------
-AppState mainMenuState(sf::RenderWindow& window, sf::Font& font) {
+AppState mainMenuState(sf::RenderWindow& window, sf::Font& font, FoodManagementSystem& fms, PaymentStage& payments) {
     Button customerBtn = createButton(font, "Food List & Order", 300, 200, 200, 50);
     Button adminBtn = createButton(font, "Admin Panel", 300, 300, 200, 50);
     Button exitBtn = createButton(font, "Exit", 300, 400, 200, 50);
@@ -253,6 +1238,8 @@ AppState mainMenuState(sf::RenderWindow& window, sf::Font& font) {
             }
         }
 
+        payments.poll(fms);
+
         window.clear(sf::Color::Black);
         window.draw(titleText);
         window.draw(customerBtn.shape);
@@ -267,17 +1254,31 @@ AppState mainMenuState(sf::RenderWindow& window, sf::Font& font) {
 }
 
 // -------------------- CustomerOrder State Handling --------------------
-AppState customerOrderState(sf::RenderWindow& window, sf::Font& font, FoodManagementSystem& fms) {
+AppState customerOrderState(sf::RenderWindow& window, sf::Font& font, FoodManagementSystem& fms, PaymentStage& payments) {
     vector<FoodNode*> foods = fms.getAllFoods();
 
     Button backBtn = createButton(font, "Back", 50, 500, 100, 40);
     Button orderBtn = createButton(font, "Place Order", 600, 500, 150, 50);
 
+    // Only one page of the menu is drawn; an imported menu can be huge
+    const size_t FOODS_PER_PAGE = 12;
+    size_t page = 0;
+    size_t pageCount = max<size_t>(1, (foods.size() + FOODS_PER_PAGE - 1) / FOODS_PER_PAGE);
+    Button prevBtn = createButton(font, "Prev", 560, 10, 100, 30);
+    Button nextBtn = createButton(font, "Next", 670, 10, 100, 30);
+    sf::Text pageText("", font, 20);
+    pageText.setPosition(50, 15);
+
     // Input fields variables
     string inputFoodNo = "";
     string inputQuantity = "";
+    string inputCard = "";
+    string inputPin = "";
     bool inputFoodNoActive = false;
     bool inputQuantityActive = false;
+    bool inputCardActive = false;
+    bool inputPinActive = false;
+    vector<PaymentResult> settled;
 
     sf::RectangleShape foodNoBox(sf::Vector2f(150, 30));
     foodNoBox.setPosition(50, 450);
@@ -287,10 +1288,22 @@ AppState customerOrderState(sf::RenderWindow& window, sf::Font& font, FoodManage
     quantityBox.setPosition(250, 450);
     quantityBox.setFillColor(sf::Color::White);
 
+    sf::RectangleShape cardBox(sf::Vector2f(200, 30));
+    cardBox.setPosition(450, 450);
+    cardBox.setFillColor(sf::Color::White);
+
+    sf::RectangleShape pinBox(sf::Vector2f(80, 30));
+    pinBox.setPosition(670, 450);
+    pinBox.setFillColor(sf::Color::White);
+
     sf::Text foodNoLabel("Food No:", font, 20);
     foodNoLabel.setPosition(50, 420);
     sf::Text quantityLabel("Quantity:", font, 20);
     quantityLabel.setPosition(250, 420);
+    sf::Text cardLabel("Card No:", font, 20);
+    cardLabel.setPosition(450, 420);
+    sf::Text pinLabel("PIN:", font, 20);
+    pinLabel.setPosition(670, 420);
 
     sf::Text inputFoodNoText("", font, 20);
     inputFoodNoText.setPosition(55, 455);
@@ -300,6 +1313,14 @@ AppState customerOrderState(sf::RenderWindow& window, sf::Font& font, FoodManage
     inputQuantityText.setPosition(255, 455);
     inputQuantityText.setFillColor(sf::Color::Black);
 
+    sf::Text inputCardText("", font, 20);
+    inputCardText.setPosition(455, 455);
+    inputCardText.setFillColor(sf::Color::Black);
+
+    sf::Text inputPinText("", font, 20);
+    inputPinText.setPosition(675, 455);
+    inputPinText.setFillColor(sf::Color::Black);
+
     sf::Text messageText("", font, 20);
     messageText.setPosition(50, 520);
     messageText.setFillColor(sf::Color::Green);
@@ -313,10 +1334,15 @@ AppState customerOrderState(sf::RenderWindow& window, sf::Font& font, FoodManage
             if (handleButtonClick(backBtn, window, event))
                 return AppState::MainMenu;
 
+            if (handleButtonClick(prevBtn, window, event) && page > 0)
+                page--;
+            if (handleButtonClick(nextBtn, window, event) && page + 1 < pageCount)
+                page++;
+
             if (handleButtonClick(orderBtn, window, event)) {
                 // Validate and process order
-                if (inputFoodNo.empty() || inputQuantity.empty()) {
-                    messageText.setString("Please enter both Food No and Quantity.");
+                if (inputFoodNo.empty() || inputQuantity.empty() || inputCard.empty() || inputPin.empty()) {
+                    messageText.setString("Please enter Food No, Quantity, Card No and PIN.");
                     messageText.setFillColor(sf::Color::Red);
                 }
                 else {
@@ -335,14 +1361,24 @@ AppState customerOrderState(sf::RenderWindow& window, sf::Font& font, FoodManage
                         messageText.setString("Insufficient stock.");
                         messageText.setFillColor(sf::Color::Red);
                     }
+                    else if (inputCard.size() != 16) {
+                        // Only a typing hint; the payment stage does the real card check
+                        messageText.setString("Card number must be 16 digits.");
+                        messageText.setFillColor(sf::Color::Red);
+                    }
+                    else if (payments.submit(fms, foodNo, quantity, inputCard, inputPin) < 0) {
+                        messageText.setString("Insufficient stock.");
+                        messageText.setFillColor(sf::Color::Red);
+                    }
                     else {
-                        fms.processOrder(foodNo, quantity);
-                        messageText.setString("Order placed: " + to_string(quantity) + " x " + food->name);
-                        messageText.setFillColor(sf::Color::Green);
+                        messageText.setString("Authorizing payment: " + to_string(quantity) + " x " + food->name);
+                        messageText.setFillColor(sf::Color::Yellow);
 
-                        // Clear inputs after success
+                        // Clear inputs; the stock stays held until the payment settles
                         inputFoodNo.clear();
                         inputQuantity.clear();
+                        inputCard.clear();
+                        inputPin.clear();
                     }
                 }
             }
@@ -353,14 +1389,32 @@ AppState customerOrderState(sf::RenderWindow& window, sf::Font& font, FoodManage
                 if (foodNoBox.getGlobalBounds().contains(static_cast<float>(mousePos.x), static_cast<float>(mousePos.y))) {
                     inputFoodNoActive = true;
                     inputQuantityActive = false;
+                    inputCardActive = false;
+                    inputPinActive = false;
                 }
                 else if (quantityBox.getGlobalBounds().contains(static_cast<float>(mousePos.x), static_cast<float>(mousePos.y))) {
                     inputFoodNoActive = false;
                     inputQuantityActive = true;
+                    inputCardActive = false;
+                    inputPinActive = false;
+                }
+                else if (cardBox.getGlobalBounds().contains(static_cast<float>(mousePos.x), static_cast<float>(mousePos.y))) {
+                    inputFoodNoActive = false;
+                    inputQuantityActive = false;
+                    inputCardActive = true;
+                    inputPinActive = false;
+                }
+                else if (pinBox.getGlobalBounds().contains(static_cast<float>(mousePos.x), static_cast<float>(mousePos.y))) {
+                    inputFoodNoActive = false;
+                    inputQuantityActive = false;
+                    inputCardActive = false;
+                    inputPinActive = true;
                 }
                 else {
                     inputFoodNoActive = false;
                     inputQuantityActive = false;
+                    inputCardActive = false;
+                    inputPinActive = false;
                 }
             }
 
@@ -381,18 +1435,69 @@ AppState customerOrderState(sf::RenderWindow& window, sf::Font& font, FoodManage
                         inputQuantity.pop_back();
                     }
                 }
+                else if (inputCardActive) {
+                    if (isdigit(event.text.unicode) && inputCard.size() < 16) {
+                        inputCard += static_cast<char>(event.text.unicode);
+                    }
+                    else if (event.text.unicode == 8 && !inputCard.empty()) { // backspace
+                        inputCard.pop_back();
+                    }
+                }
+                else if (inputPinActive) {
+                    if (isdigit(event.text.unicode) && inputPin.size() < 4) {
+                        inputPin += static_cast<char>(event.text.unicode);
+                    }
+                    else if (event.text.unicode == 8 && !inputPin.empty()) { // backspace
+                        inputPin.pop_back();
+                    }
+                }
+            }
+        }
+
+        // Settle payments that were answered or timed out since the last frame
+        settled.clear();
+        payments.poll(fms, settled);
+        for (auto& result : settled) {
+            FoodNode* food = fms.findFood(result.request.foodNo);
+            string item = to_string(result.request.quantity) + " x " + (food ? food->name : "item " + to_string(result.request.foodNo));
+            if (result.status == PaymentStatus::Approved) {
+                messageText.setString("Order placed: " + item);
+                messageText.setFillColor(sf::Color::Green);
+            }
+            else if (result.status == PaymentStatus::Declined) {
+                messageText.setString("Payment declined: " + item);
+                messageText.setFillColor(sf::Color::Red);
+            }
+            else if (result.status == PaymentStatus::TimedOut) {
+                messageText.setString("Payment timed out: " + item);
+                messageText.setFillColor(sf::Color::Red);
+            }
+            else {
+                messageText.setString("Item removed, payment voided: " + item);
+                messageText.setFillColor(sf::Color::Red);
             }
         }
 
         // Update input text display
         inputFoodNoText.setString(inputFoodNo);
         inputQuantityText.setString(inputQuantity);
+        inputCardText.setString(inputCard);
+        inputPinText.setString(string(inputPin.size(), '*'));
 
         window.clear(sf::Color::Black);
 
-        // Draw food list
+        // Draw the current page of the food list
+        pageText.setString("Page " + to_string(page + 1) + " of " + to_string(pageCount));
+        window.draw(pageText);
+        window.draw(prevBtn.shape);
+        window.draw(prevBtn.text);
+        window.draw(nextBtn.shape);
+        window.draw(nextBtn.text);
+
         float startY = 50;
-        for (auto* food : foods) {
+        size_t pageEnd = min(foods.size(), (page + 1) * FOODS_PER_PAGE);
+        for (size_t i = page * FOODS_PER_PAGE; i < pageEnd; i++) {
+            FoodNode* food = foods[i];
             sf::Text t;
             t.setFont(font);
             t.setString(to_string(food->foodNo) + ". " + food->name + " $" + to_string(food->price) + " (In stock: " + to_string(food->inStock) + ")");
@@ -409,6 +1514,12 @@ AppState customerOrderState(sf::RenderWindow& window, sf::Font& font, FoodManage
         window.draw(quantityBox);
         window.draw(inputFoodNoText);
         window.draw(inputQuantityText);
+        window.draw(cardLabel);
+        window.draw(cardBox);
+        window.draw(inputCardText);
+        window.draw(pinLabel);
+        window.draw(pinBox);
+        window.draw(inputPinText);
         window.draw(orderBtn.shape);
         window.draw(orderBtn.text);
         window.draw(backBtn.shape);
@@ -424,7 +1535,7 @@ AppState customerOrderState(sf::RenderWindow& window, sf::Font& font, FoodManage
 
             //Modified AdminLoginState
 
-AppState adminLoginState(sf::RenderWindow& window, sf::Font& font, bool& adminLoggedIn) {
+AppState adminLoginState(sf::RenderWindow& window, sf::Font& font, bool& adminLoggedIn, FoodManagementSystem& fms, PaymentStage& payments) {
     // Admin credentials
     const string ADMIN_USER = "admin";
     const string ADMIN_PASS = "pass";
@@ -510,6 +1621,8 @@ AppState adminLoginState(sf::RenderWindow& window, sf::Font& font, bool& adminLo
             }
         }
 
+        payments.poll(fms);
+
         // Update UI
         userInputText.setString(username);
         passInputText.setString(string(password.size(), '*')); // Hide password characters
@@ -531,11 +1644,12 @@ AppState adminLoginState(sf::RenderWindow& window, sf::Font& font, bool& adminLo
 
 
 // -------------------- AdminPanel State Handling --------------------
-AppState adminPanelState(sf::RenderWindow& window, sf::Font& font, FoodManagementSystem& fms) {
+AppState adminPanelState(sf::RenderWindow& window, sf::Font& font, FoodManagementSystem& fms, PaymentStage& payments) {
     Button backBtn = createButton(font, "Back", 50, 500, 100, 40);
     Button addBtn = createButton(font, "Add Food", 50, 420, 150, 40);
     Button updateBtn = createButton(font, "Update Food", 220, 420, 150, 40);
     Button deleteBtn = createButton(font, "Delete Food", 390, 420, 150, 40);
+    Button importBtn = createButton(font, "Import Menu", 560, 420, 180, 40);
 
     string inputFoodNo = "";
     string inputName = "";
@@ -547,6 +1661,11 @@ AppState adminPanelState(sf::RenderWindow& window, sf::Font& font, FoodManagemen
     sf::Text messageText("", font, 20);
     messageText.setPosition(50, 460);
 
+    // Per-row import errors, shown in the empty space above the buttons
+    sf::Text importErrorsText("", font, 18);
+    importErrorsText.setPosition(50, 50);
+    importErrorsText.setFillColor(sf::Color::Yellow);
+
     while (window.isOpen()) {
         sf::Event event;
         while (window.pollEvent(event)) {
@@ -614,9 +1733,41 @@ AppState adminPanelState(sf::RenderWindow& window, sf::Font& font, FoodManagemen
                     messageText.setFillColor(sf::Color::Red);
                 }
             }
+
+            if (handleButtonClick(importBtn, window, event)) {
+                // Supplier menus are read from the current working directory
+                string path = "menu.csv";
+                ImportReport report = importMenuFile(fms, path);
+                if (!report.opened) {
+                    path = "menu.json";
+                    report = importMenuFile(fms, path);
+                }
+                importErrorsText.setString("");
+                if (!report.opened) {
+                    messageText.setString("No menu.csv or menu.json found.");
+                    messageText.setFillColor(sf::Color::Red);
+                }
+                else {
+                    messageText.setString("Imported " + to_string(report.rowsApplied) + " items (" +
+                        to_string(static_cast<long long>(report.rowsPerSecond())) + " rows/s), " +
+                        to_string(report.errors.size()) + " errors");
+                    messageText.setFillColor(report.errors.empty() ? sf::Color::Green : sf::Color::Yellow);
+
+                    string errorLines;
+                    for (size_t i = 0; i < report.errors.size() && i < 12; i++) {
+                        errorLines += "Line " + to_string(report.errors[i].line) + ": " + report.errors[i].message + "\n";
+                    }
+                    string logPath = writeImportErrorLog(report, path);
+                    if (!logPath.empty()) errorLines += "Full list: " + logPath;
+                    importErrorsText.setString(errorLines);
+                }
+            }
         }
 
+        payments.poll(fms);
+
         window.clear(sf::Color::Black);
+        window.draw(importErrorsText);
         window.draw(messageText);
         window.draw(backBtn.shape);
         window.draw(backBtn.text);
@@ -626,14 +1777,152 @@ AppState adminPanelState(sf::RenderWindow& window, sf::Font& font, FoodManagemen
         window.draw(updateBtn.text);
         window.draw(deleteBtn.shape);
         window.draw(deleteBtn.text);
+        window.draw(importBtn.shape);
+        window.draw(importBtn.text);
 
         window.display();
     }
     return AppState::MainMenu;
 }
 
+// -------------------- Payment Benchmark --------------------
+// Feeds PaymentStage a steady stream of orders, as a row of busy kiosks would,
+// for several processor latencies. The headline number is the settle rate
+// (orders fully approved, declined or timed out per second) measured after
+// warm-up; it should match the offered load at every latency because the
+// stage keeps more batches in flight as latency grows. The last run uses a
+// hold shorter than the processor latency to check nothing stays charged.
+void runPaymentBenchmark() {
+    const int offeredPerSecond = 50000;
+    const double warmupSec = 1.0, measureSec = 2.0;
+    const int latencies[] = { 0, 25, 50, 100, 200 };
+
+    auto run = [&](int latencyMs, int holdMs) {
+        const int orders = static_cast<int>(offeredPerSecond * (warmupSec + measureSec));
+        FoodManagementSystem fms;
+        fms.insertFood(1, "Bench Item", 1.0, orders, "Bench");
+        MockPaymentProcessor processor(latencyMs, 0.05);
+        long long inWindow = 0;
+        size_t depth = 0;
+        {
+            PaymentStage payments(processor, 256, 256, holdMs);
+            vector<PaymentResult> settled;
+            int submitted = 0;
+            auto start = chrono::steady_clock::now();
+
+            while (submitted < orders || payments.busy()) {
+                double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                int due = min(orders, static_cast<int>(elapsed * offeredPerSecond));
+                for (; submitted < due; submitted++) {
+                    // Every 50th card fails the Luhn check
+                    payments.submit(fms, 1, 1, submitted % 50 == 0 ? "4111111111111112" : "4111111111111111", "1234");
+                }
+                settled.clear();
+                payments.poll(fms, settled);
+                if (elapsed >= warmupSec && elapsed < warmupSec + measureSec) inWindow += settled.size();
+                this_thread::sleep_for(chrono::milliseconds(1));
+            }
+            depth = payments.pipelineDepth();
+        }
+        FoodNode* item = fms.findFood(1);
+        cout << "latency " << latencyMs << " ms, hold " << holdMs << " ms: settle "
+            << static_cast<long long>(inWindow / measureSec) << " orders/s (offered " << offeredPerSecond
+            << "), pipeline depth " << depth << ", sold " << item->totalSold << ", net charges "
+            << processor.netCharges() << ", on hold " << item->onHold << endl;
+    };
+
+    for (int latencyMs : latencies) run(latencyMs, 60000);
+    run(200, 50);
+}
+
+// -------------------- Import Benchmark --------------------
+void printImportReport(const ImportReport& report) {
+    if (!report.opened) {
+        cout << "Could not open import file" << endl;
+        return;
+    }
+    cout << report.rowsRead << " rows read, " << report.rowsApplied << " applied, " << report.errors.size()
+        << " errors in " << report.seconds << " s (" << static_cast<long long>(report.rowsPerSecond()) << " rows/s)" << endl;
+    for (size_t i = 0; i < report.errors.size() && i < 20; i++) {
+        cout << "  line " << report.errors[i].line << ": " << report.errors[i].message << endl;
+    }
+    if (report.errors.size() > 20) cout << "  ..." << endl;
+}
+
+// Writes synthetic supplier menus with foodNo in shuffled order and imports
+// them, once with a slice per core and once forced into 8 slices so the
+// splitting is exercised on any machine. Every 7th name carries braces,
+// commas and quotes to catch slices cut inside a value; all rows must apply.
+void runImportBenchmark(int rows) {
+    const char* categories[] = { "Fast Food", "Main Course", "Desserts", "Healthy" };
+    string csv = "foodNo,name,price,stock,category\n";
+    string json = "[\n";
+    csv.reserve(static_cast<size_t>(rows) * 48);
+    json.reserve(static_cast<size_t>(rows) * 96);
+    for (int i = 0; i < rows; i++) {
+        int foodNo = static_cast<int>((static_cast<long long>(i) * 7919) % rows) + 1;
+        string number = to_string(foodNo);
+        string price = to_string(foodNo % 20 + 1) + ".99";
+        string stock = to_string(foodNo % 100);
+        bool tricky = foodNo % 7 == 0;
+        csv += number + "," + (tricky ? "\"Combo {Large}, \"\"" + number + "\"\"\"" : "Item " + number) + ","
+            + price + "," + stock + "," + categories[foodNo % 4] + "\n";
+        json += string(i ? ",\n" : "") + "{\"foodNo\": " + number + ", \"name\": \""
+            + (tricky ? "Combo {Large}, \\\"" + number + "\\\"" : "Item " + number) + "\", \"price\": " + price
+            + ", \"stock\": " + stock + ", \"category\": \"" + categories[foodNo % 4] + "\"}";
+    }
+    json += "\n]\n";
+
+    const pair<string, const string*> files[] = { { "import_bench.csv", &csv }, { "import_bench.json", &json } };
+    for (auto& file : files) {
+        ofstream(file.first, ios::binary) << *file.second;
+        for (size_t chunks : { size_t(0), size_t(8) }) {
+            FoodManagementSystem fms;
+            cout << file.first << ", " << (chunks ? to_string(chunks) + " slices" : string("slice per core")) << ": ";
+            printImportReport(importMenuFile(fms, file.first, chunks));
+            FoodNode* sample = fms.findFood(7);
+            if (sample) cout << "  item 7: " << sample->name << endl;
+        }
+        remove(file.first.c_str());
+    }
+}
+
+// Parses a command-line count in [low, high]; false if it isn't one
+bool parseCountArg(const char* arg, int low, int high, int& value) {
+    string_view text(arg);
+    auto result = from_chars(text.data(), text.data() + text.size(), value);
+    return !text.empty() && result.ec == errc() && result.ptr == text.data() + text.size() && value >= low && value <= high;
+}
+
 // -------------------- Main --------------------
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--payment-bench") {
+        runPaymentBenchmark();
+        return 0;
+    }
+    if (argc > 2 && string(argv[1]) == "--import") {
+        FoodManagementSystem fms;
+        int slices = 0;
+        if (argc > 3 && !parseCountArg(argv[3], 1, 1024, slices)) {
+            cout << "Usage: " << argv[0] << " --import <file> [slices 1-1024]" << endl;
+            return 1;
+        }
+        ImportReport report = importMenuFile(fms, argv[2], slices);
+        printImportReport(report);
+        string logPath = writeImportErrorLog(report, argv[2]);
+        if (!logPath.empty()) cout << "All errors written to " << logPath << endl;
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--import-bench") {
+        int rows = 1000000;
+        if (argc > 2 && !parseCountArg(argv[2], 1, 100000000, rows)) {
+            cout << "Usage: " << argv[0] << " --import-bench [rows 1-100000000]" << endl;
+            return 1;
+        }
+        runImportBenchmark(rows);
+        return 0;
+    }
+
     sf::RenderWindow window(sf::VideoMode(800, 600), "Food Ordering System");
     sf::Font font;
     if (!font.loadFromFile("constan.ttf")) {
@@ -649,26 +1938,29 @@ int main() {
     fms.insertFood(4, "Ice Cream", 3.99, 30, "Desserts");
     fms.insertFood(5, "Salad", 4.99, 15, "Healthy");
 
+    MockPaymentProcessor processor(300, 0.05);
+    PaymentStage payments(processor);
+
     AppState state = AppState::MainMenu;
     bool adminLoggedIn = false;
 
     while (window.isOpen()) {
         switch (state) {
         case AppState::MainMenu:
-            state = mainMenuState(window, font);
+            state = mainMenuState(window, font, fms, payments);
             break;
 
         case AppState::CustomerOrder:
-            state = customerOrderState(window, font, fms);
+            state = customerOrderState(window, font, fms, payments);
             break;
 
         case AppState::AdminLogin:
-            state = adminLoginState(window, font, adminLoggedIn);
+            state = adminLoginState(window, font, adminLoggedIn, fms, payments);
             break;
 
         case AppState::AdminPanel:
             if (adminLoggedIn) {
-                state = adminPanelState(window, font, fms);
+                state = adminPanelState(window, font, fms, payments);
             }
             else {
                 state = AppState::AdminLogin;